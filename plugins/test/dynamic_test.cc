@@ -144,7 +144,7 @@ class AdditionalStream {
                    const TestHttpContext::Headers* response_headers,
                    const std::vector<std::string>* request_body_chunks,
                    const std::vector<std::string>* response_body_chunks)
-      : handle_(handle),
+      : handle_(std::move(handle)),
         cfg_(*cfg),
         request_headers_(request_headers),
         response_headers_(response_headers),
@@ -198,8 +198,8 @@ absl::Status AdditionalStream::Advance() {
           next_action_ = NextAction::kSendRequestBody;
           continue;
         }
-        auto res = stream_->SendRequestHeaders(*request_headers_);
-        benchmark::DoNotOptimize(res);
+        stream_->DoSendRequestHeaders(*request_headers_);
+        benchmark::ClobberMemory();
         next_action_ = NextAction::kSendRequestBody;
         return handle_->wasm()->isFailed() ? absl::InternalError("VM failed!")
                                            : absl::OkStatus();
@@ -209,9 +209,10 @@ absl::Status AdditionalStream::Advance() {
         if (!remaining_request_body_chunks_.empty()) {
           std::string chunk = std::move(remaining_request_body_chunks_.front());
           remaining_request_body_chunks_.pop_front();
-          auto res = stream_->SendRequestBody(
-              chunk, /*end_of_stream=*/remaining_request_body_chunks_.empty());
-          benchmark::DoNotOptimize(res);
+          stream_->DoSendRequestBody(
+              chunk,
+              /*end_of_stream=*/remaining_request_body_chunks_.empty());
+          benchmark::ClobberMemory();
           return handle_->wasm()->isFailed() ? absl::InternalError("VM failed!")
                                              : absl::OkStatus();
         }
@@ -224,8 +225,8 @@ absl::Status AdditionalStream::Advance() {
           next_action_ = NextAction::kSendResponseBody;
           continue;
         }
-        auto res = stream_->SendResponseHeaders(*response_headers_);
-        benchmark::DoNotOptimize(res);
+        stream_->DoSendResponseHeaders(*response_headers_);
+        benchmark::ClobberMemory();
         next_action_ = NextAction::kSendResponseBody;
         return handle_->wasm()->isFailed() ? absl::InternalError("VM failed!")
                                            : absl::OkStatus();
@@ -236,9 +237,10 @@ absl::Status AdditionalStream::Advance() {
           std::string chunk =
               std::move(remaining_response_body_chunks_.front());
           remaining_response_body_chunks_.pop_front();
-          auto res = stream_->SendResponseBody(
-              chunk, /*end_of_stream=*/remaining_response_body_chunks_.empty());
-          benchmark::DoNotOptimize(res);
+          stream_->DoSendResponseBody(
+              chunk,
+              /*end_of_stream=*/remaining_response_body_chunks_.empty());
+          benchmark::ClobberMemory();
           return handle_->wasm()->isFailed() ? absl::InternalError("VM failed!")
                                              : absl::OkStatus();
         }
@@ -273,16 +275,16 @@ DynamicTest::LoadWasm(bool benchmark) {
   }
   auto log_level = proxy_wasm::LogLevel(ll - 1);  // enum conversion, yuck
 
-  // Load wasm bytes.
-  auto wasm = ReadDataFile(env_.wasm_path());
+  // Load wasm bytes. Cached; every test and benchmark re-loads the module.
+  auto wasm = ReadDataFileCached(env_.wasm_path());
   if (!wasm.ok()) return wasm.status();
 
   // Load plugin config from disk, if configured.
-  std::string plugin_config = "";
+  std::string_view plugin_config = "";
   if (!env_.config_path().empty()) {
-    auto config = ReadDataFile(env_.config_path());
+    auto config = ReadDataFileCached(env_.config_path());
     if (!config.ok()) return config.status();
-    plugin_config = *config;
+    plugin_config = **config;
   }
 
   // Context options: logging to file, setting the clock.
@@ -295,7 +297,7 @@ DynamicTest::LoadWasm(bool benchmark) {
   }
 
   // Create VM and load wasm.
-  return CreatePluginVm(engine_, *wasm, plugin_config, log_level,
+  return CreatePluginVm(engine_, **wasm, plugin_config, log_level,
                         std::move(opt));
 }
 
@@ -370,12 +372,15 @@ void DynamicTest::TestBody() {
       } else {
         chunks = {*complete_input_body};
       }
+      // Reassembled output is usually about as large as the input; reserve
+      // once so per-chunk appends don't regrow the buffer.
+      body_result.body.reserve(complete_input_body->size());
       for (int i = 0; i < chunks.size(); ++i) {
         // When there are no trailers, the last body chunk is end of stream.
         TestHttpContext::Result res =
             invoke_wasm(std::move(chunks[i]), i == chunks.size() - 1);
         ASSERT_VM_HEALTH(phase, handle, stream);
-        body_result.body = body_result.body.append(res.body);
+        body_result.body.append(res.body);
       }
       CheckPhaseResults(phase, invocation.result(), stream, body_result);
     }
@@ -557,12 +562,10 @@ void DynamicTest::BenchHttpHandlers(benchmark::State& state) {
   for (auto _ : state) {
     // Pausing timing is not recommended. One way we could avoid it:
     // - include stream context create/destroy cost in handler benchmarks
-    // - don't hand ownership of body chunks to stream context
     state.PauseTiming();
     stream.emplace(handle, &cfg_);  // create/destroy TestHttpContext
-    std::vector<std::string> request_body_chunks_copies = *request_body_chunks;
-    std::vector<std::string> response_body_chunks_copies =
-        *response_body_chunks;
+    // Body chunks are passed as views and copied internally, so the prepared
+    // chunks can be replayed every iteration without cloning them here.
 
     // Advance a fraction of additional streams, if present.
     if (!additional_streams.empty()) {
@@ -576,27 +579,25 @@ void DynamicTest::BenchHttpHandlers(benchmark::State& state) {
     state.ResumeTiming();
 
     if (request_headers) {
-      auto res = stream->SendRequestHeaders(*request_headers);
-      benchmark::DoNotOptimize(res);
+      stream->DoSendRequestHeaders(*request_headers);
+      benchmark::ClobberMemory();
       BM_RETURN_IF_FAILED(handle);
     }
-    for (int i = 0; i < request_body_chunks_copies.size(); ++i) {
-      std::string& body = request_body_chunks_copies[i];
-      auto res = stream->SendRequestBody(
-        std::move(body), i == request_body_chunks_copies.size() - 1);
-      benchmark::DoNotOptimize(res);
+    for (int i = 0; i < request_body_chunks->size(); ++i) {
+      stream->DoSendRequestBody((*request_body_chunks)[i],
+                                i == request_body_chunks->size() - 1);
+      benchmark::ClobberMemory();
       BM_RETURN_IF_FAILED(handle);
     }
     if (response_headers) {
-      auto res = stream->SendResponseHeaders(*response_headers);
-      benchmark::DoNotOptimize(res);
+      stream->DoSendResponseHeaders(*response_headers);
+      benchmark::ClobberMemory();
       BM_RETURN_IF_FAILED(handle);
     }
-    for (int i = 0; i < response_body_chunks_copies.size(); ++i) {
-      std::string& body = response_body_chunks_copies[i];
-      auto res = stream->SendResponseBody(
-        std::move(body), i == response_body_chunks_copies.size() - 1);
-      benchmark::DoNotOptimize(res);
+    for (int i = 0; i < response_body_chunks->size(); ++i) {
+      stream->DoSendResponseBody((*response_body_chunks)[i],
+                                 i == response_body_chunks->size() - 1);
+      benchmark::ClobberMemory();
       BM_RETURN_IF_FAILED(handle);
     }
   }
@@ -642,10 +643,10 @@ void DynamicTest::CheckPhaseResults(const std::string& phase,
           header.key(), it->second);
     }
   }
-  // Check serialized headers.
+  // Check serialized headers. Emit in sorted order for deterministic output.
   if (expect.headers_size() > 0) {
     std::vector<std::string> headers;
-    for (const auto& kv : result.headers) {
+    for (const auto& kv : result.headers.SortedPairs()) {
       headers.emplace_back(absl::StrCat(kv.first, ": ", kv.second));
     }
     for (const auto& match : expect.headers()) {
@@ -768,8 +769,10 @@ absl::Status ParseHTTP1Headers(const std::string& content, bool is_request,
 
   // Emit normal headers to map, coalescing as we go. Convert header keys to
   // lowercase like Envoy does. The wasm header map is also case insensitive.
+  // Well-known names hit the interned table and skip the lowercasing copy.
+  std::string scratch;
   for (const auto& [key, value] : headers.lines()) {
-    hdrs.InsertOrAppend(absl::AsciiStrToLower(key), value);
+    hdrs.InsertOrAppend(LowerHeaderName(key, &scratch), value);
   }
   return absl::OkStatus();
 }
@@ -16,10 +16,15 @@
 
 #pragma once
 
+#include <cstring>
 #include <string>
 
+#include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "boost/algorithm/string.hpp"
 #include "boost/filesystem/path.hpp"
@@ -41,7 +46,8 @@ struct ContextOptions {
 };
 
 // Buffer class to handle copying to and from an individual BODY chunk.
-class Buffer : public proxy_wasm::BufferBase {
+// Final so body-buffer calls devirtualize where the concrete type is visible.
+class Buffer final : public proxy_wasm::BufferBase {
  public:
   Buffer() = default;
 
@@ -63,6 +69,12 @@ class Buffer : public proxy_wasm::BufferBase {
     clear();
     owned_string_buffer_ = std::move(data);
   }
+  // Copy data in, reusing this buffer's existing capacity.
+  void assign(std::string_view data) {
+    clear();
+    owned_string_buffer_.assign(data.data(), data.size());
+  }
+  const std::string& str() const { return owned_string_buffer_; }
   std::string release() { return std::move(owned_string_buffer_); }
 
  private:
@@ -76,18 +88,26 @@ class TestContext : public proxy_wasm::TestContext {
   // VM Context constructor.
   TestContext(proxy_wasm::WasmBase* wasm) : proxy_wasm::TestContext(wasm) {
     // No plugin config in VM context.
+    frozen_time_nanos_ = absl::ToUnixNanos(options().clock_time);
   }
   // Root Context constructor.
   TestContext(proxy_wasm::WasmBase* wasm,
               std::shared_ptr<proxy_wasm::PluginBase> plugin)
       : proxy_wasm::TestContext(wasm, plugin) {
+    // Non-owning view; the PluginBase owns the config bytes and outlives this
+    // context. The only copy of the config is the ABI-mandated one into wasm
+    // linear memory when the plugin calls getBufferBytes.
     plugin_config_.set(plugin_->plugin_configuration_);
+    frozen_time_nanos_ = absl::ToUnixNanos(options().clock_time);
   }
-  // Stream Context constructor.
+  // Stream Context constructor. Takes the handle by reference: the base
+  // class keeps the one owning copy; no transient refcount traffic here.
   TestContext(proxy_wasm::WasmBase* wasm, uint32_t parent_context_id,
-              std::shared_ptr<proxy_wasm::PluginHandleBase> plugin_handle)
+              const std::shared_ptr<proxy_wasm::PluginHandleBase>& plugin_handle)
       : proxy_wasm::TestContext(wasm, parent_context_id, plugin_handle) {
+    // Non-owning view, as above.
     plugin_config_.set(plugin_->plugin_configuration_);
+    frozen_time_nanos_ = absl::ToUnixNanos(options().clock_time);
   }
   virtual ~TestContext() = default;
 
@@ -98,11 +118,11 @@ class TestContext : public proxy_wasm::TestContext {
   // --- BEGIN Wasm facing API ---
   proxy_wasm::BufferInterface* getBuffer(
       proxy_wasm::WasmBufferType type) override;
-  uint64_t getCurrentTimeNanoseconds() override;
-  uint64_t getMonotonicTimeNanoseconds() override;
+  uint64_t getCurrentTimeNanoseconds() final;
+  uint64_t getMonotonicTimeNanoseconds() final;
   proxy_wasm::WasmResult log(uint32_t log_level,
-                             std::string_view message) override;
-  void error(std::string_view message) override;
+                             std::string_view message) final;
+  void error(std::string_view message) final;
   // --- END   Wasm facing API ---
 
   // --- BEGIN Testing facilities ---
@@ -121,8 +141,67 @@ class TestContext : public proxy_wasm::TestContext {
 
  private:
   proxy_wasm::BufferBase plugin_config_;
+  // Options().clock_time is fixed for the life of the TestWasm; convert it to
+  // nanos once so clock hostcalls are a member load.
+  uint64_t frozen_time_nanos_ = 0;
+};
+
+// Small-integer tokens for well-known HTTP header names (the interned set in
+// LowerHeaderName). kNone for anything else.
+enum class WellKnownHeader : uint8_t {
+  kNone = 0,
+  kAuthority,
+  kMethod,
+  kPath,
+  kScheme,
+  kStatus,
+  kAccept,
+  kAcceptEncoding,
+  kAcceptLanguage,
+  kAuthorization,
+  kCacheControl,
+  kConnection,
+  kContentEncoding,
+  kContentLength,
+  kContentType,
+  kCookie,
+  kDate,
+  kEtag,
+  kHost,
+  kLocation,
+  kReferer,
+  kServer,
+  kSetCookie,
+  kTransferEncoding,
+  kUserAgent,
+  kVary,
+  kVia,
+  kXForwardedFor,
+  kXForwardedProto,
 };
 
+// Maps a header name in any casing to its well-known token, or kNone.
+WellKnownHeader WellKnownHeaderToken(absl::string_view name);
+
+// SWAR ASCII lowercasing: adds 0x20 to every 'A'-'Z' byte in the word, eight
+// bytes at a time, leaving all other bytes (including non-ASCII) untouched.
+inline uint64_t SwarToLower(uint64_t v) {
+  constexpr uint64_t kOnes = 0x0101010101010101ULL;
+  constexpr uint64_t kHigh = 0x8080808080808080ULL;
+  const uint64_t heptets = v & ~kHigh;
+  const uint64_t ge_a = heptets + (0x80 - 'A') * kOnes;   // high bit: >= 'A'
+  const uint64_t gt_z = heptets + (0x7F - 'Z') * kOnes;   // high bit: > 'Z'
+  const uint64_t upper = (ge_a & ~gt_z & ~v) & kHigh;     // flag upper ASCII
+  return v | (upper >> 2);  // 0x80 >> 2 == 0x20
+}
+
+// Loads up to 8 bytes little-end-padded with zeros into a word.
+inline uint64_t LoadPartialWord(const char* p, size_t n) {
+  uint64_t v = 0;
+  memcpy(&v, p, n);
+  return v;
+}
+
 // TestHttpContext is a GCP-like ProxyWasm Stream context. It primarily
 // implements HTTP methods usable by Wasm.
 //
@@ -132,10 +211,14 @@ class TestContext : public proxy_wasm::TestContext {
 // - restricted header checks
 // - empty value checks
 // - size checks
-class TestHttpContext : public TestContext {
+// Final so that LTO/devirtualization can turn the wasm->host header-map
+// callbacks into direct (and inlinable) calls when the concrete context type
+// is known at the call site.
+class TestHttpContext final : public TestContext {
  public:
-  TestHttpContext(std::shared_ptr<proxy_wasm::PluginHandleBase> plugin_handle,
-                  const pb::Test* cfg)
+  TestHttpContext(
+      const std::shared_ptr<proxy_wasm::PluginHandleBase>& plugin_handle,
+      const pb::Test* cfg)
       : TestContext(plugin_handle->wasm().get(),
                     plugin_handle->wasm()
                         ->getRootContext(plugin_handle->plugin(),
@@ -199,17 +282,123 @@ class TestHttpContext : public TestContext {
     }
   };
 
-  // Key-sorted header map with case-insensitive key comparison.
-  class Headers : public std::map<std::string, std::string, caseless_compare> {
+  // Case-insensitive hash with heterogeneous ("transparent") lookup, so that
+  // map operations accept string_view keys without constructing std::string.
+  struct CaselessHash {
+    using is_transparent = void;
+    size_t operator()(absl::string_view v) const {
+      // Hash lowercased bytes; header names are short, so a stack buffer
+      // covers all realistic keys.
+      char buf[128];
+      if (v.size() <= sizeof(buf)) {
+        for (size_t i = 0; i < v.size(); ++i) {
+          buf[i] = absl::ascii_tolower(v[i]);
+        }
+        return absl::HashOf(absl::string_view(buf, v.size()));
+      }
+      return absl::HashOf(absl::AsciiStrToLower(v));
+    }
+  };
+
+  // Case-insensitive equality with heterogeneous lookup, as above. Compares
+  // eight bytes per step (SWAR) rather than byte-wise tolower: header names
+  // are short, so most compares finish in one or two word operations.
+  struct CaselessEq {
+    using is_transparent = void;
+    bool operator()(absl::string_view a, absl::string_view b) const {
+      if (a.size() != b.size()) return false;
+      size_t i = 0;
+      for (; i + 8 <= a.size(); i += 8) {
+        if (SwarToLower(LoadPartialWord(a.data() + i, 8)) !=
+            SwarToLower(LoadPartialWord(b.data() + i, 8))) {
+          return false;
+        }
+      }
+      if (i == a.size()) return true;
+      return SwarToLower(LoadPartialWord(a.data() + i, a.size() - i)) ==
+             SwarToLower(LoadPartialWord(b.data() + i, a.size() - i));
+    }
+  };
+
+  // Header map with case-insensitive keys, unique per key. Requests in these
+  // tests carry a handful of headers, so storage is an inlined vector: at
+  // small N everything sits in one or two cache lines, lookups hash nothing,
+  // and the typical map fits in the inline capacity with no heap allocation
+  // at all. Entries are kept sorted by case-insensitive name as a class
+  // invariant, so lookups binary-search and SortedPairs() is a straight copy
+  // with no per-emission sort.
+  class Headers {
    public:
+    // Entry members are named like a map pair so call sites read naturally.
+    // Well-known names additionally carry their token, computed once on
+    // insert, so lookups by a well-known name reduce to integer compares.
+    struct Entry {
+      std::string first;
+      std::string second;
+      WellKnownHeader token = WellKnownHeader::kNone;
+    };
+    using value_type = Entry;
+    using Storage = absl::InlinedVector<value_type, 8>;
+    using iterator = Storage::iterator;
+    using const_iterator = Storage::const_iterator;
+
+    iterator begin() { return entries_.begin(); }
+    iterator end() { return entries_.end(); }
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    void clear() { entries_.clear(); }
+    void reserve(size_t n) { entries_.reserve(n); }
+
+    // Case-insensitive binary search; end() if absent.
+    iterator find(absl::string_view key);
+    const_iterator find(absl::string_view key) const;
+
+    // Adds a header, or overwrites the value of an existing one.
+    void insert_or_assign(absl::string_view key, absl::string_view value) {
+      auto it = LowerBound(key);
+      if (it != entries_.end() && CaselessEq()(it->first, key)) {
+        it->second.assign(value.data(), value.size());
+      } else {
+        entries_.insert(it, value_type{std::string(key), std::string(value),
+                                       WellKnownHeaderToken(key)});
+      }
+    }
+
     void InsertOrAppend(absl::string_view key, absl::string_view value) {
-      auto& val = operator[](std::string(key));
-      if (val.empty()) {
-        val = std::string(value);
+      auto it = LowerBound(key);
+      if (it == entries_.end() || !CaselessEq()(it->first, key)) {
+        entries_.insert(it, value_type{std::string(key), std::string(value),
+                                       WellKnownHeaderToken(key)});
+      } else if (it->second.empty()) {
+        it->second.assign(value.data(), value.size());
       } else {
-        val = absl::StrCat(val, ", ", value);  // RFC 9110 Field Order
+        // Append in place (RFC 9110 field order) rather than concatenating
+        // into a fresh string and discarding the old buffer.
+        it->second.reserve(it->second.size() + 2 + value.size());
+        it->second.append(", ");
+        it->second.append(value.data(), value.size());
       }
     }
+
+    size_t erase(absl::string_view key) {
+      auto it = find(key);
+      if (it == end()) return 0;
+      entries_.erase(it);
+      return 1;
+    }
+
+    // Key-sorted (case-insensitive) view of the map. The returned views point
+    // into this map and are invalidated by any mutation.
+    std::vector<std::pair<absl::string_view, absl::string_view>> SortedPairs()
+        const;
+
+   private:
+    // First entry whose name does not sort before key.
+    iterator LowerBound(absl::string_view key);
+
+    Storage entries_;
   };
 
   struct Result {
@@ -228,10 +417,22 @@ class TestHttpContext : public TestContext {
   };
 
   // Testing helpers. Use these instead of direct on*Headers methods.
-  Result SendRequestHeaders(Headers headers);
-  Result SendRequestBody(std::string body, bool end_of_stream);
-  Result SendResponseHeaders(Headers headers);
-  Result SendResponseBody(std::string body, bool end_of_stream);
+  // Input headers are copied into result_, reusing its storage; callers may
+  // pass the same Headers to many streams (e.g. benchmark iterations).
+  Result SendRequestHeaders(const Headers& headers);
+  Result SendRequestBody(std::string_view body, bool end_of_stream);
+  Result SendResponseHeaders(const Headers& headers);
+  Result SendResponseBody(std::string_view body, bool end_of_stream);
+
+  // Low-level variants that leave the outcome in internal state rather than
+  // moving a Result out. Benchmarks use these: they don't inspect results,
+  // and not moving the Result lets its containers keep their capacity across
+  // iterations. Body input is copied into a buffer whose capacity is likewise
+  // reused, so steady-state iterations allocate nothing for bodies.
+  void DoSendRequestHeaders(const Headers& headers);
+  void DoSendRequestBody(std::string_view body, bool end_of_stream);
+  void DoSendResponseHeaders(const Headers& headers);
+  void DoSendResponseBody(std::string_view body, bool end_of_stream);
 
   enum CallbackType {
     None,
@@ -242,11 +443,21 @@ class TestHttpContext : public TestContext {
   };
 
  private:
+  // Reset per-phase state in result_, retaining allocated capacity where the
+  // underlying containers allow it. Cheaper than `result_ = Result{}`.
+  void ResetResult();
+
+  bool InPhase(proxy_wasm::WasmHeaderMapType type) const {
+    return active_phases_mask_ & (1u << static_cast<unsigned>(type));
+  }
+
   const pb::Test& cfg_;
   // Ensure that we invoke teardown handlers just once.
   bool torn_down_ = false;
-  // State tracked during a headers call. Invalid otherwise.
-  proxy_wasm::WasmHeaderMapType phase_;
+  // Bitmask of header-map phases active during the current callback, indexed
+  // by WasmHeaderMapType. Zero outside of headers callbacks, so the per-call
+  // guard in each accessor is a single test instruction.
+  uint8_t active_phases_mask_ = 0;
   Result result_;
   bool sent_local_response_ = false;
 
@@ -255,7 +466,7 @@ class TestHttpContext : public TestContext {
 };
 
 // TestWasm is a light wrapper enabling custom TestContext.
-class TestWasm : public proxy_wasm::WasmBase {
+class TestWasm final : public proxy_wasm::WasmBase {
  public:
   TestWasm(std::unique_ptr<proxy_wasm::WasmVm> vm, ContextOptions options)
       : proxy_wasm::WasmBase(std::move(vm), /*vm_id=*/"",
@@ -279,16 +490,30 @@ class TestWasm : public proxy_wasm::WasmBase {
   ContextOptions options_;
 };
 
+// Returns a lowercased view of an HTTP header name. Well-known names resolve
+// to a statically interned string with no allocation (the common case when
+// parsing test inputs); anything else is lowercased into *scratch. The
+// returned view is valid for the lifetime of *scratch or the process.
+absl::string_view LowerHeaderName(absl::string_view name, std::string* scratch);
+
 // Helper to read a file from disk.
 absl::StatusOr<std::string> ReadDataFile(const std::string& path);
 
-// Helper to scan for .wasm files next to the executing binary.
-std::vector<std::string> FindPlugins();
+// Helper to read a file from disk, memoizing contents by path for the lifetime
+// of the process. Parameterized tests and benchmarks reload the same wasm
+// modules and plugin configs for every (engine, test) combination; this keeps
+// each file to a single disk read. The returned pointer is stable and owned by
+// the cache. Thread-safe.
+absl::StatusOr<const std::string*> ReadDataFileCached(const std::string& path);
+
+// Helper to scan for .wasm files next to the executing binary. The scan runs
+// once; subsequent calls return the cached list.
+const std::vector<std::string>& FindPlugins();
 
 // Helper to create a VM and load wasm.
 absl::StatusOr<std::shared_ptr<proxy_wasm::PluginHandleBase>> CreatePluginVm(
     const std::string& engine, const std::string& wasm_bytes,
-    const std::string& plugin_config, proxy_wasm::LogLevel min_log_level,
+    std::string_view plugin_config, proxy_wasm::LogLevel min_log_level,
     ContextOptions options);
 
 // Helper to initialize a plugin.
@@ -299,7 +524,7 @@ absl::Status InitializePlugin(
 absl::StatusOr<std::shared_ptr<proxy_wasm::PluginHandleBase>>
 CreateProxyWasmPlugin(
     const std::string& engine, const std::string& wasm_path,
-    const std::string& plugin_config = "",
+    std::string_view plugin_config = "",
     proxy_wasm::LogLevel min_log_level = proxy_wasm::LogLevel::critical);
 
 // HttpTest is the actual test fixture.
@@ -315,8 +540,10 @@ class HttpTest
   std::string path() { return std::get<1>(GetParam()); }
 
  protected:
-  // Load VM and plugin and set these into the handle_ variable.
-  absl::Status CreatePlugin(const std::string& plugin_config = "");
+  // Load VM and plugin and set these into the handle_ variable. Handles are
+  // shared across tests with the same (engine, wasm, config) parameters, so
+  // the module is loaded and compiled once per combination.
+  absl::Status CreatePlugin(std::string_view plugin_config = "");
 
   TestContext* root() {
     if (!handle_) return nullptr;